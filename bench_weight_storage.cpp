@@ -0,0 +1,240 @@
+#include "mlp.h"
+#include "reduced_mlp.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+float identity(float value) { return value; }
+
+/**
+ * @brief float32 network in ReducedMLP's flat layout
+ *
+ * Runs through the same detail::flat_forward loop as ReducedMLP, with an
+ * identity widening, so comparing it against fp16/bf16 isolates the effect
+ * of 16-bit storage from the layout and loop structure.
+ */
+class FlatMLP {
+public:
+  explicit FlatMLP(const mlp::MLP &model)
+      : input_size_(model.input_size()),
+        hidden_layer_size_(model.hidden_layer_size()) {
+    for (const auto &neuron : model.hidden_weights()) {
+      weights_.insert(weights_.end(), neuron.begin(), neuron.end());
+    }
+    weights_.insert(weights_.end(), model.output_weights().begin(),
+                    model.output_weights().end());
+  }
+
+  // Kept out of line like ReducedMLP::forward, which lives in the library
+  [[gnu::noinline]] float forward(const std::vector<float> &inputs) const {
+    if (inputs.size() != input_size_) {
+      throw std::invalid_argument("Input size mismatch");
+    }
+    return mlp::detail::flat_forward<float, identity>(
+        weights_.data(), inputs, input_size_, hidden_layer_size_);
+  }
+
+  size_t weight_bytes() const { return weights_.size() * sizeof(float); }
+
+private:
+  unsigned int input_size_;
+  unsigned int hidden_layer_size_;
+  std::vector<float> weights_;
+};
+
+/**
+ * @brief Estimate the memory used by a float32 MLP, including the heap
+ * allocations of its nested weight vectors
+ *
+ * @param network Network to measure
+ * @return size_t Approximate footprint in bytes
+ */
+size_t mlp_footprint(const mlp::MLP &network) {
+  size_t bytes = sizeof(mlp::MLP);
+  for (const auto &neuron : network.hidden_weights()) {
+    bytes += neuron.capacity() * sizeof(float);
+  }
+  bytes += network.hidden_weights().capacity() * sizeof(std::vector<float>);
+  bytes += network.output_weights().capacity() * sizeof(float);
+  return bytes;
+}
+
+/**
+ * @brief Run predictions against randomly chosen networks, as a branch
+ * predictor would when indexing one network per branch PC
+ *
+ * @param networks Networks to predict with (float32 or reduced)
+ * @param inputs Pool of input vectors
+ * @param model_indices Network to use for each prediction
+ * @param checksum Sum of all predictions (keeps the work from being optimized
+ * away)
+ * @return double Average nanoseconds per prediction
+ */
+template <typename Network>
+double time_predictions(const std::vector<Network> &networks,
+                        const std::vector<std::vector<float>> &inputs,
+                        const std::vector<size_t> &model_indices,
+                        double &checksum) {
+  checksum = 0.0;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < model_indices.size(); ++i) {
+    checksum +=
+        networks[model_indices[i]].forward(inputs[i % inputs.size()]);
+  }
+  auto end = std::chrono::steady_clock::now();
+  std::chrono::duration<double, std::nano> elapsed = end - start;
+  return elapsed.count() / model_indices.size();
+}
+
+void print_usage(const char *program_name) {
+  std::cout << "Usage: " << program_name
+            << " [num_networks] [input_size] [hidden_layer_size] "
+               "[predictions]\n";
+  std::cout << "\n";
+  std::cout << "Arguments:\n";
+  std::cout << "  num_networks      - Number of networks held at once "
+               "(default: 100000)\n";
+  std::cout << "  input_size        - Inputs per network (default: 16)\n";
+  std::cout << "  hidden_layer_size - Hidden neurons per network (default: "
+               "8)\n";
+  std::cout << "  predictions       - Predictions to time (default: "
+               "2000000)\n";
+}
+
+int main(int argc, char *argv[]) {
+  if (argc > 5) {
+    print_usage(argv[0]);
+    return 1;
+  }
+
+  size_t num_networks = (argc >= 2) ? std::stoul(argv[1]) : 100000;
+  unsigned int input_size = (argc >= 3) ? std::stoul(argv[2]) : 16;
+  unsigned int hidden_layer_size = (argc >= 4) ? std::stoul(argv[3]) : 8;
+  size_t predictions = (argc >= 5) ? std::stoul(argv[4]) : 2000000;
+
+  if (num_networks == 0 || input_size == 0 || predictions == 0) {
+    print_usage(argv[0]);
+    return 1;
+  }
+
+  std::cout << "=== Weight Storage Benchmark ===" << std::endl;
+  std::cout << "  Networks: " << num_networks << " x (" << input_size
+            << " inputs, " << hidden_layer_size << " hidden)" << std::endl;
+  std::cout << "  Predictions: " << predictions << std::endl;
+  std::cout << std::endl;
+
+  // Build the float32 networks and their flat and reduced copies
+  std::vector<mlp::MLP> fp32_networks;
+  fp32_networks.reserve(num_networks);
+  for (size_t i = 0; i < num_networks; ++i) {
+    fp32_networks.emplace_back(input_size, hidden_layer_size);
+  }
+  std::vector<FlatMLP> flat_networks;
+  std::vector<mlp::ReducedMLP> fp16_networks;
+  std::vector<mlp::ReducedMLP> bf16_networks;
+  flat_networks.reserve(num_networks);
+  fp16_networks.reserve(num_networks);
+  bf16_networks.reserve(num_networks);
+  for (const auto &network : fp32_networks) {
+    flat_networks.emplace_back(network);
+    fp16_networks.emplace_back(network, mlp::WeightFormat::FP16);
+    bf16_networks.emplace_back(network, mlp::WeightFormat::BF16);
+  }
+
+  // Random history bit patterns and random network selection
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> bit(0, 1);
+  std::vector<std::vector<float>> inputs(1024, std::vector<float>(input_size));
+  for (auto &input : inputs) {
+    for (auto &value : input) {
+      value = static_cast<float>(bit(gen));
+    }
+  }
+  std::uniform_int_distribution<size_t> pick(0, num_networks - 1);
+  std::vector<size_t> model_indices(predictions);
+  for (auto &index : model_indices) {
+    index = pick(gen);
+  }
+
+  // Memory footprint
+  size_t fp32_bytes = 0;
+  size_t flat_bytes = 0;
+  size_t reduced_bytes = 0;
+  for (size_t i = 0; i < num_networks; ++i) {
+    fp32_bytes += mlp_footprint(fp32_networks[i]);
+    flat_bytes += sizeof(FlatMLP) + flat_networks[i].weight_bytes();
+    reduced_bytes += sizeof(mlp::ReducedMLP) + fp16_networks[i].weight_bytes();
+  }
+  size_t payload_values =
+      hidden_layer_size * (input_size + 1) + hidden_layer_size + 1;
+
+  // Throughput
+  double fp32_checksum, flat_checksum, fp16_checksum, bf16_checksum;
+  double fp32_ns =
+      time_predictions(fp32_networks, inputs, model_indices, fp32_checksum);
+  double flat_ns =
+      time_predictions(flat_networks, inputs, model_indices, flat_checksum);
+  double fp16_ns =
+      time_predictions(fp16_networks, inputs, model_indices, fp16_checksum);
+  double bf16_ns =
+      time_predictions(bf16_networks, inputs, model_indices, bf16_checksum);
+
+  // Accuracy cost of the reduced formats
+  float fp16_max_error = 0.0f;
+  float bf16_max_error = 0.0f;
+  for (size_t i = 0; i < std::min<size_t>(predictions, 100000); ++i) {
+    const auto &input = inputs[i % inputs.size()];
+    float reference = fp32_networks[model_indices[i]].forward(input);
+    fp16_max_error =
+        std::max(fp16_max_error,
+                 std::fabs(fp16_networks[model_indices[i]].forward(input) -
+                           reference));
+    bf16_max_error =
+        std::max(bf16_max_error,
+                 std::fabs(bf16_networks[model_indices[i]].forward(input) -
+                           reference));
+  }
+
+  std::cout << std::fixed << std::setprecision(2);
+  std::cout << "Memory footprint:" << std::endl;
+  std::cout << "  fp32 weight payload: "
+            << num_networks * payload_values * sizeof(float) / 1024.0
+            << " KiB" << std::endl;
+  std::cout << "  fp32 flat incl. containers: " << flat_bytes / 1024.0
+            << " KiB" << std::endl;
+  std::cout << "  fp32 MLP incl. containers (reference): "
+            << fp32_bytes / 1024.0 << " KiB" << std::endl;
+  std::cout << "  fp16/bf16 weight payload: "
+            << num_networks * payload_values * sizeof(uint16_t) / 1024.0
+            << " KiB" << std::endl;
+  std::cout << "  fp16/bf16 incl. containers: " << reduced_bytes / 1024.0
+            << " KiB" << std::endl;
+  std::cout << std::endl;
+
+  // fp32 flat, fp16 and bf16 share the layout and forward loop; only the
+  // stored width differs. The MLP line also includes its nested vectors and
+  // per-call allocation.
+  std::cout << "Throughput (ns per prediction):" << std::endl;
+  std::cout << "  fp32 flat: " << flat_ns << std::endl;
+  std::cout << "  fp16:      " << fp16_ns << " (" << fp16_ns / flat_ns
+            << "x fp32 flat)" << std::endl;
+  std::cout << "  bf16:      " << bf16_ns << " (" << bf16_ns / flat_ns
+            << "x fp32 flat)" << std::endl;
+  std::cout << "  fp32 MLP (reference): " << fp32_ns << std::endl;
+  std::cout << std::endl;
+
+  std::cout << std::setprecision(6);
+  std::cout << "Max absolute output error vs fp32:" << std::endl;
+  std::cout << "  fp16: " << fp16_max_error << std::endl;
+  std::cout << "  bf16: " << bf16_max_error << std::endl;
+  std::cout << "Checksums: " << fp32_checksum << " " << flat_checksum << " "
+            << fp16_checksum << " " << bf16_checksum << std::endl;
+
+  return 0;
+}
@@ -1,5 +1,10 @@
 #include "mlp.h"
+#include "mlp_server.h"
+#include "pruning.h"
+#include "reduced_mlp.h"
+#include <atomic>
 #include <iostream>
+#include <thread>
 #include <vector>
 
 int main() {
@@ -99,6 +104,125 @@ int main() {
   std::cout << "  Weights saved to mlp_2_4.txt" << std::endl;
   std::cout << std::endl;
 
+  // Example 6: Serving predictions while a trainer publishes new weights
+  std::cout << "Example 6: Concurrent inference with hot weight swap"
+            << std::endl;
+
+  mlp::MLP trainer_network(2, 4);
+  mlp::MLPServer server(trainer_network);
+  std::atomic<bool> training_done(false);
+  std::vector<unsigned long> predictions_per_reader(4, 0);
+
+  // Reader threads keep predicting without taking any locks
+  std::vector<std::thread> readers;
+  for (size_t r = 0; r < predictions_per_reader.size(); ++r) {
+    readers.emplace_back([&, r]() {
+      mlp::MLPServer::Reader reader = server.register_reader();
+      while (!training_done.load()) {
+        reader.forward(xor_inputs[predictions_per_reader[r] % 4]);
+        ++predictions_per_reader[r];
+      }
+    });
+  }
+
+  // Trainer refines its own copy and publishes a snapshot after each round
+  for (int round = 0; round < 50; ++round) {
+    trainer_network.train(xor_inputs, xor_targets, 100, 0.5f);
+    server.publish(trainer_network);
+  }
+  training_done.store(true);
+  for (auto &reader : readers) {
+    reader.join();
+  }
+
+  unsigned long total_predictions = 0;
+  for (unsigned long count : predictions_per_reader) {
+    total_predictions += count;
+  }
+  std::cout << "  Published " << server.version() << " snapshots while "
+            << readers.size() << " readers made " << total_predictions
+            << " predictions" << std::endl;
+
+  mlp::MLPServer::Reader reader = server.register_reader();
+  std::cout << "  Served predictions after training:" << std::endl;
+  for (size_t i = 0; i < xor_inputs.size(); ++i) {
+    std::cout << "    [" << xor_inputs[i][0] << ", " << xor_inputs[i][1]
+              << "] -> " << reader.forward(xor_inputs[i])
+              << " (target: " << xor_targets[i] << ")" << std::endl;
+  }
+  std::cout << std::endl;
+
+  // Example 7: Storing trained weights in 16-bit formats for inference
+  std::cout << "Example 7: fp16 and bf16 weight storage" << std::endl;
+
+  mlp::ReducedMLP xor_fp16(xor_network, mlp::WeightFormat::FP16);
+  mlp::ReducedMLP xor_bf16(xor_network, mlp::WeightFormat::BF16);
+  for (size_t i = 0; i < xor_inputs.size(); ++i) {
+    std::cout << "    [" << xor_inputs[i][0] << ", " << xor_inputs[i][1]
+              << "] -> fp32: " << xor_network.forward(xor_inputs[i])
+              << ", fp16: " << xor_fp16.forward(xor_inputs[i])
+              << ", bf16: " << xor_bf16.forward(xor_inputs[i]) << std::endl;
+  }
+
+  // Round trip through the reduced weights file
+  xor_fp16.save_weights();
+  mlp::ReducedMLP loaded_fp16 =
+      mlp::ReducedMLP::load_weights("mlp_2_4_fp16.txt");
+  std::cout << "  Weights saved to mlp_2_4_fp16.txt and reloaded ("
+            << loaded_fp16.weight_bytes() << " bytes of weights)" << std::endl;
+
+  // Widen back to a float32 master copy to continue training
+  mlp::MLP master_copy = loaded_fp16.to_mlp();
+  master_copy.train(xor_inputs, xor_targets, 100, 0.5f);
+  std::cout << "  Fine-tuned float32 master copy: [1, 0] -> "
+            << master_copy.forward(xor_inputs[2]) << std::endl;
+  std::cout << std::endl;
+
+  // Example 8: Pruning hidden neurons and input bits that barely contribute
+  std::cout << "Example 8: Structured pruning" << std::endl;
+
+  // 4 input bits, but the target only depends on bits 0 and 1 (XOR)
+  std::vector<std::vector<float>> noisy_inputs;
+  std::vector<float> noisy_targets;
+  for (unsigned int bits = 0; bits < 16; ++bits) {
+    std::vector<float> input(4);
+    for (unsigned int j = 0; j < 4; ++j) {
+      input[j] = static_cast<float>((bits >> j) & 1);
+    }
+    noisy_inputs.push_back(input);
+    noisy_targets.push_back(static_cast<float>((bits ^ (bits >> 1)) & 1));
+  }
+
+  mlp::MLP wide_network(4, 8);
+  wide_network.train(noisy_inputs, noisy_targets, 5000, 0.5f);
+
+  mlp::PruneOptions prune_options;
+  prune_options.criterion = mlp::PruneCriterion::Sensitivity;
+  prune_options.hidden_neurons_to_remove = 4;
+  prune_options.inputs_to_remove = 2;
+  prune_options.fine_tune_epochs = 1000;
+  prune_options.learning_rate = 0.5f;
+  mlp::PruneResult pruned =
+      mlp::prune(wide_network, noisy_inputs, noisy_targets, noisy_inputs,
+                 noisy_targets, prune_options);
+
+  std::cout << "  Pruned 4x8 network to " << pruned.model.input_size() << "x"
+            << pruned.model.hidden_layer_size() << ", kept input bits: [";
+  for (size_t j = 0; j < pruned.input_mask.size(); ++j) {
+    std::cout << pruned.input_mask[j];
+    if (j < pruned.input_mask.size() - 1) {
+      std::cout << ", ";
+    }
+  }
+  std::cout << "]" << std::endl;
+  std::cout << "  Accuracy before: " << pruned.accuracy_before
+            << ", after: " << pruned.accuracy_after << std::endl;
+  std::cout << "  [1, 0, 1, 1] -> "
+            << pruned.model.forward(mlp::apply_input_mask(
+                   {1.0f, 0.0f, 1.0f, 1.0f}, pruned.input_mask))
+            << std::endl;
+  std::cout << std::endl;
+
   std::cout << "=== All examples completed successfully ===" << std::endl;
 
   return 0;
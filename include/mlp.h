@@ -63,6 +63,28 @@ public:
    */
   void save_weights() const;
 
+  /**
+   * @brief Get the number of input neurons
+   */
+  unsigned int input_size() const { return input_size_; }
+
+  /**
+   * @brief Get the number of neurons in the hidden layer
+   */
+  unsigned int hidden_layer_size() const { return hidden_layer_size_; }
+
+  /**
+   * @brief Get the hidden layer weights and biases (Input→Hidden)
+   */
+  const std::vector<std::vector<float>> &hidden_weights() const {
+    return hidden_weights_;
+  }
+
+  /**
+   * @brief Get the output layer weights and bias (Hidden→Output)
+   */
+  const std::vector<float> &output_weights() const { return output_weights_; }
+
   /**
    * @brief Stream insertion operator for printing MLP
    */
@@ -0,0 +1,142 @@
+#ifndef MLP_SERVER_H
+#define MLP_SERVER_H
+
+#include "mlp.h"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace mlp {
+
+/**
+ * @brief Thread-safe serving wrapper around an MLP
+ *
+ * Publishes immutable MLP snapshots through an atomic pointer so that many
+ * threads can run inference while a trainer keeps refining its own copy of
+ * the model. Readers take no locks: each one announces the epoch it is
+ * reading in, loads the current snapshot and clears its announcement when
+ * done. Replaced snapshots are retired and only freed once no reader can
+ * still be using them (epoch-based reclamation).
+ *
+ * Usage:
+ *   MLPServer server(model);
+ *   // Reader thread
+ *   MLPServer::Reader reader = server.register_reader();
+ *   float p = reader.forward(inputs);
+ *   // Trainer thread
+ *   model.train(inputs, targets, 1);
+ *   server.publish(model);
+ */
+class MLPServer {
+public:
+  /**
+   * @brief Maximum number of readers registered at the same time
+   */
+  static constexpr size_t kMaxReaders = 64;
+
+  /**
+   * @brief Per-thread handle used to run inference on the current snapshot
+   *
+   * A Reader owns one reader slot of its server and must only be used by one
+   * thread at a time. It must not outlive the server that created it.
+   */
+  class Reader {
+  public:
+    Reader(Reader &&other) noexcept;
+    Reader &operator=(Reader &&other) noexcept;
+    Reader(const Reader &) = delete;
+    Reader &operator=(const Reader &) = delete;
+
+    /**
+     * @brief Release the reader slot
+     */
+    ~Reader();
+
+    /**
+     * @brief Forward propagation through the currently published snapshot
+     *
+     * @param inputs Input vector (must have size equal to input_size)
+     * @return float Output prediction (sigmoid activated)
+     */
+    float forward(const std::vector<float> &inputs) const;
+
+  private:
+    friend class MLPServer;
+    Reader(MLPServer *server, size_t slot);
+
+    MLPServer *server_;
+    size_t slot_;
+  };
+
+  /**
+   * @brief Construct a new MLPServer object
+   *
+   * @param initial Model to serve until the first publish (copied)
+   */
+  explicit MLPServer(const MLP &initial);
+
+  /**
+   * @brief Destroy the MLPServer object
+   *
+   * All readers must have been destroyed before the server.
+   */
+  ~MLPServer();
+
+  MLPServer(const MLPServer &) = delete;
+  MLPServer &operator=(const MLPServer &) = delete;
+
+  /**
+   * @brief Claim a reader slot for the calling thread
+   *
+   * @return Reader Handle used to run inference
+   * @throws std::runtime_error if all kMaxReaders slots are in use
+   */
+  Reader register_reader();
+
+  /**
+   * @brief Publish a new snapshot of the model
+   *
+   * Copies the model and atomically replaces the served snapshot. Readers
+   * already inside forward finish on the previous snapshot. Snapshots that no
+   * reader can still observe are freed. Concurrent publishers are serialized.
+   *
+   * @param model Model to publish (must have the same input_size)
+   */
+  void publish(const MLP &model);
+
+  /**
+   * @brief Number of snapshots published since construction
+   */
+  uint64_t version() const;
+
+private:
+  /**
+   * @brief Reader slot, padded to its own cache line to avoid false sharing
+   */
+  struct alignas(64) ReaderSlot {
+    std::atomic<bool> in_use{false};
+    std::atomic<uint64_t> epoch{0}; // 0 = not currently reading
+  };
+
+  /**
+   * @brief Free retired snapshots no active reader can observe
+   *
+   * Must be called with publish_mutex_ held.
+   */
+  void reclaim();
+
+  const unsigned int input_size_;
+  std::atomic<const MLP *> current_;
+  std::atomic<uint64_t> global_epoch_{1};
+  ReaderSlot slots_[kMaxReaders];
+
+  std::mutex publish_mutex_;
+  // Retired snapshots with the epoch in which they were replaced
+  std::vector<std::pair<const MLP *, uint64_t>> retired_;
+};
+
+} // namespace mlp
+
+#endif // MLP_SERVER_H
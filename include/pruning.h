@@ -0,0 +1,95 @@
+#ifndef PRUNING_H
+#define PRUNING_H
+
+#include "mlp.h"
+#include <vector>
+
+namespace mlp {
+
+/**
+ * @brief How hidden neurons and input bits are scored for pruning
+ */
+enum class PruneCriterion {
+  // Neuron: |output weight|. Input: sum of |hidden weights| in its column,
+  // each scaled by the neuron's |output weight|.
+  Magnitude,
+  // Mean absolute change of the prediction over the validation set when the
+  // neuron (or input) is replaced by its mean value.
+  Sensitivity
+};
+
+/**
+ * @brief Options for prune()
+ */
+struct PruneOptions {
+  PruneCriterion criterion = PruneCriterion::Magnitude;
+  unsigned int hidden_neurons_to_remove = 0;
+  unsigned int inputs_to_remove = 0;
+  unsigned int fine_tune_epochs = 100; // 0 disables fine-tuning
+  float learning_rate = 0.1f;
+};
+
+/**
+ * @brief Result of prune()
+ */
+struct PruneResult {
+  MLP model; // Pruned (and fine-tuned) network
+  // Original input index of each input of the pruned network; use
+  // apply_input_mask to build its inputs from full-size input vectors
+  std::vector<unsigned int> input_mask;
+  std::vector<unsigned int> kept_hidden_neurons; // Original neuron indices
+  float accuracy_before; // Validation accuracy of the original network
+  float accuracy_after;  // Validation accuracy of the pruned network
+};
+
+/**
+ * @brief Remove the least important hidden neurons and input bits
+ *
+ * Scores hidden neurons and input columns on the validation set, removes the
+ * lowest scoring ones and folds their mean contribution into the downstream
+ * biases. The resulting smaller network is then fine-tuned on the training
+ * set (with its inputs remapped through the input mask). Hidden neurons are
+ * pruned first; inputs are scored against the remaining neurons.
+ *
+ * @param model Trained network to prune (not modified)
+ * @param training_inputs Full-size training samples used for fine-tuning
+ * (validated even when fine-tuning is disabled; may then be empty)
+ * @param training_targets Training targets (one per sample)
+ * @param validation_inputs Full-size samples used for scoring and accuracy
+ * @param validation_targets Validation targets (one per sample)
+ * @param options Criterion, how much to remove and fine-tuning parameters
+ * @return PruneResult Pruned network, input mask and accuracy cost
+ */
+PruneResult prune(const MLP &model,
+                  const std::vector<std::vector<float>> &training_inputs,
+                  const std::vector<float> &training_targets,
+                  const std::vector<std::vector<float>> &validation_inputs,
+                  const std::vector<float> &validation_targets,
+                  const PruneOptions &options);
+
+/**
+ * @brief Select the inputs kept by a pruned network
+ *
+ * @param inputs Full-size input vector of the original network
+ * @param input_mask Input mask from PruneResult
+ * @return std::vector<float> Input vector for the pruned network
+ */
+std::vector<float>
+apply_input_mask(const std::vector<float> &inputs,
+                 const std::vector<unsigned int> &input_mask);
+
+/**
+ * @brief Fraction of samples whose prediction, thresholded at 0.5, matches
+ * the target
+ *
+ * @param model Network to evaluate
+ * @param inputs Input samples
+ * @param targets Target outputs (0 or 1, one per sample)
+ * @return float Accuracy in range [0, 1]
+ */
+float accuracy(const MLP &model, const std::vector<std::vector<float>> &inputs,
+               const std::vector<float> &targets);
+
+} // namespace mlp
+
+#endif // PRUNING_H
@@ -0,0 +1,181 @@
+#ifndef REDUCED_MLP_H
+#define REDUCED_MLP_H
+
+#include "mlp.h"
+#include <cmath>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace mlp {
+
+/**
+ * @brief 16-bit storage format for ReducedMLP weights
+ */
+enum class WeightFormat {
+  FP16, // IEEE 754 half precision (1 sign, 5 exponent, 10 mantissa bits)
+  BF16  // bfloat16 (1 sign, 8 exponent, 7 mantissa bits)
+};
+
+namespace detail {
+
+inline float flat_sigmoid(float x) { return 1.0f / (1.0f + std::exp(-x)); }
+
+/**
+ * @brief Forward pass over weights stored in one flat buffer
+ *
+ * The layout is the one used by ReducedMLP: hidden neurons row by row
+ * (input_size + 1 values each, bias last), followed by the output weights and
+ * bias. Widen converts one stored value to float and is fixed at compile
+ * time so the inner dot product has no per-weight dispatch. Exposed so that
+ * benchmarks can run a float32 buffer through the identical loop.
+ *
+ * @param weights Start of the flat weight buffer
+ * @param inputs Input vector (must have size equal to input_size)
+ * @param input_size Number of input neurons
+ * @param hidden_layer_size Number of neurons in the hidden layer
+ * @return float Output prediction (sigmoid activated)
+ */
+template <typename Weight, float (*Widen)(Weight)>
+float flat_forward(const Weight *weights, const std::vector<float> &inputs,
+                   unsigned int input_size, unsigned int hidden_layer_size) {
+  const size_t row_size = static_cast<size_t>(input_size) + 1;
+  const Weight *output_weights = weights + hidden_layer_size * row_size;
+
+  float output_sum = 0.0f;
+  for (size_t i = 0; i < hidden_layer_size; ++i) {
+    const Weight *row = weights + i * row_size;
+
+    // Compute weighted sum (MAC operation) for hidden neuron i
+    float sum = 0.0f;
+    for (size_t j = 0; j < input_size; ++j) {
+      sum += inputs[j] * Widen(row[j]);
+    }
+    sum += Widen(row[input_size]); // Add bias
+
+    // Accumulate directly into the output neuron
+    output_sum += flat_sigmoid(sum) * Widen(output_weights[i]);
+  }
+  output_sum += Widen(output_weights[hidden_layer_size]); // Add bias
+
+  return flat_sigmoid(output_sum);
+}
+
+} // namespace detail
+
+/**
+ * @brief Inference-only MLP with 16-bit weight storage
+ *
+ * Holds the same network as an MLP, but stores all weights and biases as
+ * fp16 or bf16 in one contiguous buffer, halving the footprint when many
+ * small predictors (e.g. one per branch PC) are kept at once. Weights are
+ * widened to float on the fly during the forward dot product.
+ *
+ * Training stays on the float32 MLP: build a ReducedMLP from a trained MLP,
+ * or call to_mlp() to get a float32 master copy to train further.
+ */
+class ReducedMLP {
+public:
+  /**
+   * @brief Construct a new ReducedMLP object by narrowing an MLP's weights
+   *
+   * @param model Trained float32 network
+   * @param format 16-bit format used to store the weights
+   */
+  ReducedMLP(const MLP &model, WeightFormat format);
+
+  /**
+   * @brief Forward propagation through the network
+   *
+   * @param inputs Input vector (must have size equal to input_size)
+   * @return float Output prediction (sigmoid activated)
+   */
+  float forward(const std::vector<float> &inputs) const;
+
+  /**
+   * @brief Widen the weights back into a float32 MLP
+   *
+   * @return MLP Network with the same (rounded) weights, suitable for training
+   */
+  MLP to_mlp() const;
+
+  /**
+   * @brief Save weights and biases to a file
+   *
+   * Saves to a file named mlp_<input_size>_<hidden_size>_<format>.txt
+   * Format: A header line "<format> <input_size> <hidden_size>", followed by
+   * the same layout as MLP::save_weights with each value written as the
+   * 4-digit hex encoding of its 16-bit representation
+   */
+  void save_weights() const;
+
+  /**
+   * @brief Load a network written by save_weights
+   *
+   * @param filename Path to the weights file
+   * @return ReducedMLP Loaded network
+   */
+  static ReducedMLP load_weights(const std::string &filename);
+
+  /**
+   * @brief Get the number of input neurons
+   */
+  unsigned int input_size() const { return input_size_; }
+
+  /**
+   * @brief Get the number of neurons in the hidden layer
+   */
+  unsigned int hidden_layer_size() const { return hidden_layer_size_; }
+
+  /**
+   * @brief Get the weight storage format
+   */
+  WeightFormat format() const { return format_; }
+
+  /**
+   * @brief Number of bytes used to store weights and biases
+   */
+  size_t weight_bytes() const { return weights_.size() * sizeof(uint16_t); }
+
+  /**
+   * @brief Name of a weight format ("fp16" or "bf16")
+   */
+  static std::string format_name(WeightFormat format);
+
+  /**
+   * @brief Stream insertion operator for printing ReducedMLP
+   */
+  friend std::ostream &operator<<(std::ostream &os, const ReducedMLP &mlp);
+
+private:
+  ReducedMLP(unsigned int input_size, unsigned int hidden_layer_size,
+             WeightFormat format, std::vector<uint16_t> weights);
+
+  /**
+   * @brief Number of weights and biases of a network, computed in size_t
+   */
+  static size_t weight_count(unsigned int input_size,
+                             unsigned int hidden_layer_size);
+
+  /**
+   * @brief Round a float to the nearest 16-bit value (ties to even)
+   */
+  static uint16_t narrow(float value, WeightFormat format);
+
+  /**
+   * @brief Widen a 16-bit value to float
+   */
+  static float widen(uint16_t value, WeightFormat format);
+
+  unsigned int input_size_;
+  unsigned int hidden_layer_size_;
+  WeightFormat format_;
+  // Hidden neurons row by row (input_size + 1 values each, bias last),
+  // followed by the output weights and bias (hidden_layer_size + 1 values)
+  std::vector<uint16_t> weights_;
+};
+
+} // namespace mlp
+
+#endif // REDUCED_MLP_H
@@ -0,0 +1,126 @@
+#include "mlp_server.h"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace mlp {
+
+MLPServer::Reader::Reader(MLPServer *server, size_t slot)
+    : server_(server), slot_(slot) {}
+
+MLPServer::Reader::Reader(Reader &&other) noexcept
+    : server_(other.server_), slot_(other.slot_) {
+  other.server_ = nullptr;
+}
+
+MLPServer::Reader &MLPServer::Reader::operator=(Reader &&other) noexcept {
+  if (this != &other) {
+    if (server_ != nullptr) {
+      server_->slots_[slot_].in_use.store(false, std::memory_order_release);
+    }
+    server_ = other.server_;
+    slot_ = other.slot_;
+    other.server_ = nullptr;
+  }
+  return *this;
+}
+
+MLPServer::Reader::~Reader() {
+  if (server_ != nullptr) {
+    server_->slots_[slot_].in_use.store(false, std::memory_order_release);
+  }
+}
+
+float MLPServer::Reader::forward(const std::vector<float> &inputs) const {
+  if (server_ == nullptr) {
+    throw std::logic_error("Reader has been moved from");
+  }
+  ReaderSlot &slot = server_->slots_[slot_];
+
+  // Announce the epoch before loading the snapshot. Both operations are
+  // sequentially consistent, so a publisher that swaps the pointer after our
+  // load is guaranteed to see this announcement when it scans the slots.
+  slot.epoch.store(server_->global_epoch_.load());
+  const MLP *model = server_->current_.load();
+
+  // Clear the announcement on every exit path, including forward throwing
+  struct EpochGuard {
+    std::atomic<uint64_t> &epoch;
+    ~EpochGuard() { epoch.store(0, std::memory_order_release); }
+  } guard{slot.epoch};
+
+  return model->forward(inputs);
+}
+
+MLPServer::MLPServer(const MLP &initial)
+    : input_size_(initial.input_size()), current_(new MLP(initial)) {}
+
+MLPServer::~MLPServer() {
+  delete current_.load();
+  for (const auto &entry : retired_) {
+    delete entry.first;
+  }
+}
+
+MLPServer::Reader MLPServer::register_reader() {
+  for (size_t i = 0; i < kMaxReaders; ++i) {
+    bool expected = false;
+    if (!slots_[i].in_use.load(std::memory_order_relaxed) &&
+        slots_[i].in_use.compare_exchange_strong(expected, true,
+                                                 std::memory_order_acquire)) {
+      return Reader(this, i);
+    }
+  }
+  throw std::runtime_error("All " + std::to_string(kMaxReaders) +
+                           " reader slots are in use");
+}
+
+void MLPServer::publish(const MLP &model) {
+  if (model.input_size() != input_size_) {
+    throw std::invalid_argument("Published model input size mismatch: "
+                                "expected " +
+                                std::to_string(input_size_) + " but got " +
+                                std::to_string(model.input_size()));
+  }
+
+  // Build the snapshot outside the lock; only the swap is serialized
+  const MLP *snapshot = new MLP(model);
+
+  std::lock_guard<std::mutex> lock(publish_mutex_);
+  const MLP *previous = current_.exchange(snapshot);
+
+  // Readers that announce the new epoch load the pointer after the exchange
+  // and therefore can only see the new snapshot
+  const uint64_t retire_epoch = global_epoch_.fetch_add(1) + 1;
+  retired_.emplace_back(previous, retire_epoch);
+
+  reclaim();
+}
+
+uint64_t MLPServer::version() const { return global_epoch_.load() - 1; }
+
+void MLPServer::reclaim() {
+  // Find the oldest epoch any reader is still in
+  uint64_t oldest_active = std::numeric_limits<uint64_t>::max();
+  for (size_t i = 0; i < kMaxReaders; ++i) {
+    const uint64_t epoch = slots_[i].epoch.load();
+    if (epoch != 0) {
+      oldest_active = std::min(oldest_active, epoch);
+    }
+  }
+
+  // A snapshot retired in epoch E is unreachable once every active reader
+  // announced E or later
+  auto it = std::remove_if(retired_.begin(), retired_.end(),
+                           [oldest_active](const auto &entry) {
+                             if (entry.second <= oldest_active) {
+                               delete entry.first;
+                               return true;
+                             }
+                             return false;
+                           });
+  retired_.erase(it, retired_.end());
+}
+
+} // namespace mlp
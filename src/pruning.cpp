@@ -0,0 +1,326 @@
+#include "pruning.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+namespace mlp {
+
+namespace {
+
+float sigmoid(float x) { return 1.0f / (1.0f + std::exp(-x)); }
+
+// Weighted sums (before activation) of every hidden neuron for one sample
+std::vector<float> hidden_sums(const MLP &model,
+                               const std::vector<float> &inputs) {
+  const auto &hidden_weights = model.hidden_weights();
+  const unsigned int input_size = model.input_size();
+
+  std::vector<float> sums(model.hidden_layer_size());
+  for (size_t i = 0; i < sums.size(); ++i) {
+    float sum = hidden_weights[i][input_size]; // Bias
+    for (size_t j = 0; j < input_size; ++j) {
+      sum += inputs[j] * hidden_weights[i][j];
+    }
+    sums[i] = sum;
+  }
+  return sums;
+}
+
+// Output neuron weighted sum given the hidden layer outputs
+float output_sum(const MLP &model, const std::vector<float> &hidden_outputs) {
+  const auto &output_weights = model.output_weights();
+  float sum = output_weights[hidden_outputs.size()]; // Bias
+  for (size_t i = 0; i < hidden_outputs.size(); ++i) {
+    sum += hidden_outputs[i] * output_weights[i];
+  }
+  return sum;
+}
+
+// Indices of the highest scoring entries, in their original order
+std::vector<unsigned int> keep_highest(const std::vector<float> &scores,
+                                       unsigned int to_remove) {
+  std::vector<unsigned int> order(scores.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [&scores](unsigned int a, unsigned int b) {
+                     return scores[a] < scores[b];
+                   });
+  std::vector<unsigned int> kept(order.begin() + to_remove, order.end());
+  std::sort(kept.begin(), kept.end());
+  return kept;
+}
+
+std::vector<float> score_hidden_neurons(
+    const MLP &model, const std::vector<std::vector<float>> &inputs,
+    const std::vector<float> &mean_activations, PruneCriterion criterion) {
+  const auto &output_weights = model.output_weights();
+  std::vector<float> scores(model.hidden_layer_size(), 0.0f);
+
+  if (criterion == PruneCriterion::Magnitude) {
+    for (size_t i = 0; i < scores.size(); ++i) {
+      scores[i] = std::fabs(output_weights[i]);
+    }
+    return scores;
+  }
+
+  // Sensitivity: replacing neuron i by its mean activation shifts the output
+  // sum by output_weights[i] * (mean - activation)
+  for (const auto &sample : inputs) {
+    std::vector<float> activations = hidden_sums(model, sample);
+    for (auto &a : activations) {
+      a = sigmoid(a);
+    }
+    const float sum = output_sum(model, activations);
+    const float output = sigmoid(sum);
+    for (size_t i = 0; i < scores.size(); ++i) {
+      const float shift =
+          output_weights[i] * (mean_activations[i] - activations[i]);
+      scores[i] += std::fabs(sigmoid(sum + shift) - output);
+    }
+  }
+  for (auto &score : scores) {
+    score /= inputs.size();
+  }
+  return scores;
+}
+
+std::vector<float> score_inputs(const MLP &model,
+                                const std::vector<std::vector<float>> &inputs,
+                                const std::vector<float> &mean_inputs,
+                                PruneCriterion criterion) {
+  const auto &hidden_weights = model.hidden_weights();
+  const auto &output_weights = model.output_weights();
+  const unsigned int hidden_layer_size = model.hidden_layer_size();
+  std::vector<float> scores(model.input_size(), 0.0f);
+
+  if (criterion == PruneCriterion::Magnitude) {
+    for (size_t j = 0; j < scores.size(); ++j) {
+      for (size_t i = 0; i < hidden_layer_size; ++i) {
+        scores[j] += std::fabs(hidden_weights[i][j] * output_weights[i]);
+      }
+    }
+    return scores;
+  }
+
+  // Sensitivity: replace input j by its mean and recompute the prediction
+  std::vector<float> activations(hidden_layer_size);
+  for (const auto &sample : inputs) {
+    const std::vector<float> sums = hidden_sums(model, sample);
+    for (size_t i = 0; i < hidden_layer_size; ++i) {
+      activations[i] = sigmoid(sums[i]);
+    }
+    const float output = sigmoid(output_sum(model, activations));
+
+    for (size_t j = 0; j < scores.size(); ++j) {
+      const float delta = mean_inputs[j] - sample[j];
+      for (size_t i = 0; i < hidden_layer_size; ++i) {
+        activations[i] = sigmoid(sums[i] + hidden_weights[i][j] * delta);
+      }
+      scores[j] += std::fabs(sigmoid(output_sum(model, activations)) - output);
+    }
+  }
+  for (auto &score : scores) {
+    score /= inputs.size();
+  }
+  return scores;
+}
+
+// Keep only the given hidden neurons, folding the mean contribution of the
+// removed ones into the output bias
+MLP remove_hidden_neurons(const MLP &model,
+                          const std::vector<unsigned int> &kept,
+                          const std::vector<float> &mean_activations) {
+  const auto &output_weights = model.output_weights();
+  const unsigned int hidden_layer_size = model.hidden_layer_size();
+
+  float output_bias = output_weights[hidden_layer_size];
+  for (size_t i = 0; i < hidden_layer_size; ++i) {
+    if (!std::binary_search(kept.begin(), kept.end(), i)) {
+      output_bias += output_weights[i] * mean_activations[i];
+    }
+  }
+
+  std::vector<std::vector<float>> new_hidden_weights;
+  std::vector<float> new_output_weights;
+  for (unsigned int i : kept) {
+    new_hidden_weights.push_back(model.hidden_weights()[i]);
+    new_output_weights.push_back(output_weights[i]);
+  }
+  new_output_weights.push_back(output_bias);
+
+  return MLP(model.input_size(), kept.size(), new_hidden_weights,
+             new_output_weights);
+}
+
+// Keep only the given inputs, folding the mean contribution of the removed
+// ones into each hidden neuron's bias
+MLP remove_inputs(const MLP &model, const std::vector<unsigned int> &kept,
+                  const std::vector<float> &mean_inputs) {
+  const unsigned int input_size = model.input_size();
+
+  std::vector<std::vector<float>> new_hidden_weights;
+  for (const auto &neuron : model.hidden_weights()) {
+    std::vector<float> weights;
+    float bias = neuron[input_size];
+    for (size_t j = 0; j < input_size; ++j) {
+      if (std::binary_search(kept.begin(), kept.end(), j)) {
+        weights.push_back(neuron[j]);
+      } else {
+        bias += neuron[j] * mean_inputs[j];
+      }
+    }
+    weights.push_back(bias);
+    new_hidden_weights.push_back(weights);
+  }
+
+  return MLP(kept.size(), model.hidden_layer_size(), new_hidden_weights,
+             model.output_weights());
+}
+
+} // namespace
+
+PruneResult prune(const MLP &model,
+                  const std::vector<std::vector<float>> &training_inputs,
+                  const std::vector<float> &training_targets,
+                  const std::vector<std::vector<float>> &validation_inputs,
+                  const std::vector<float> &validation_targets,
+                  const PruneOptions &options) {
+  const unsigned int input_size = model.input_size();
+  const unsigned int hidden_layer_size = model.hidden_layer_size();
+
+  // Validate options, training and validation data
+  if (options.hidden_neurons_to_remove >= hidden_layer_size) {
+    throw std::invalid_argument(
+        "Cannot remove " + std::to_string(options.hidden_neurons_to_remove) +
+        " of " + std::to_string(hidden_layer_size) + " hidden neurons");
+  }
+  if (options.inputs_to_remove >= input_size) {
+    throw std::invalid_argument(
+        "Cannot remove " + std::to_string(options.inputs_to_remove) + " of " +
+        std::to_string(input_size) + " inputs");
+  }
+  if (validation_inputs.empty() ||
+      validation_inputs.size() != validation_targets.size()) {
+    throw std::invalid_argument(
+        "Validation data must be non-empty with one target per input");
+  }
+  for (size_t sample = 0; sample < validation_inputs.size(); ++sample) {
+    if (validation_inputs[sample].size() != input_size) {
+      throw std::invalid_argument(
+          "Validation input size mismatch at sample " +
+          std::to_string(sample));
+    }
+  }
+  if (training_inputs.size() != training_targets.size()) {
+    throw std::invalid_argument(
+        "Number of training inputs must match number of targets");
+  }
+  if (options.fine_tune_epochs > 0 && training_inputs.empty()) {
+    throw std::invalid_argument("Training data cannot be empty when "
+                                "fine-tuning");
+  }
+  for (size_t sample = 0; sample < training_inputs.size(); ++sample) {
+    if (training_inputs[sample].size() != input_size) {
+      throw std::invalid_argument("Training input size mismatch at sample " +
+                                  std::to_string(sample));
+    }
+  }
+
+  const float accuracy_before =
+      accuracy(model, validation_inputs, validation_targets);
+
+  // === Prune hidden neurons ===
+  std::vector<float> mean_activations(hidden_layer_size, 0.0f);
+  for (const auto &sample : validation_inputs) {
+    const std::vector<float> sums = hidden_sums(model, sample);
+    for (size_t i = 0; i < hidden_layer_size; ++i) {
+      mean_activations[i] += sigmoid(sums[i]);
+    }
+  }
+  for (auto &mean : mean_activations) {
+    mean /= validation_inputs.size();
+  }
+
+  std::vector<unsigned int> kept_hidden_neurons = keep_highest(
+      score_hidden_neurons(model, validation_inputs, mean_activations,
+                           options.criterion),
+      options.hidden_neurons_to_remove);
+  MLP pruned =
+      remove_hidden_neurons(model, kept_hidden_neurons, mean_activations);
+
+  // === Prune inputs ===
+  std::vector<float> mean_inputs(input_size, 0.0f);
+  for (const auto &sample : validation_inputs) {
+    for (size_t j = 0; j < input_size; ++j) {
+      mean_inputs[j] += sample[j];
+    }
+  }
+  for (auto &mean : mean_inputs) {
+    mean /= validation_inputs.size();
+  }
+
+  std::vector<unsigned int> input_mask = keep_highest(
+      score_inputs(pruned, validation_inputs, mean_inputs, options.criterion),
+      options.inputs_to_remove);
+  pruned = remove_inputs(pruned, input_mask, mean_inputs);
+
+  // === Fine-tune ===
+  if (options.fine_tune_epochs > 0) {
+    std::vector<std::vector<float>> masked_training_inputs;
+    masked_training_inputs.reserve(training_inputs.size());
+    for (const auto &sample : training_inputs) {
+      masked_training_inputs.push_back(apply_input_mask(sample, input_mask));
+    }
+    pruned.train(masked_training_inputs, training_targets,
+                 options.fine_tune_epochs, options.learning_rate);
+  }
+
+  std::vector<std::vector<float>> masked_validation_inputs;
+  masked_validation_inputs.reserve(validation_inputs.size());
+  for (const auto &sample : validation_inputs) {
+    masked_validation_inputs.push_back(apply_input_mask(sample, input_mask));
+  }
+  const float accuracy_after =
+      accuracy(pruned, masked_validation_inputs, validation_targets);
+
+  return PruneResult{pruned, input_mask, kept_hidden_neurons, accuracy_before,
+                     accuracy_after};
+}
+
+std::vector<float>
+apply_input_mask(const std::vector<float> &inputs,
+                 const std::vector<unsigned int> &input_mask) {
+  std::vector<float> masked(input_mask.size());
+  for (size_t j = 0; j < input_mask.size(); ++j) {
+    if (input_mask[j] >= inputs.size()) {
+      throw std::invalid_argument("Input mask index " +
+                                  std::to_string(input_mask[j]) +
+                                  " out of range for input size " +
+                                  std::to_string(inputs.size()));
+    }
+    masked[j] = inputs[input_mask[j]];
+  }
+  return masked;
+}
+
+float accuracy(const MLP &model, const std::vector<std::vector<float>> &inputs,
+               const std::vector<float> &targets) {
+  if (inputs.empty() || inputs.size() != targets.size()) {
+    throw std::invalid_argument(
+        "Accuracy requires non-empty data with one target per input");
+  }
+
+  size_t correct = 0;
+  for (size_t sample = 0; sample < inputs.size(); ++sample) {
+    const float prediction =
+        model.forward(inputs[sample]) >= 0.5f ? 1.0f : 0.0f;
+    if (prediction == targets[sample]) {
+      ++correct;
+    }
+  }
+  return static_cast<float>(correct) / inputs.size();
+}
+
+} // namespace mlp
@@ -0,0 +1,312 @@
+#include "reduced_mlp.h"
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace mlp {
+
+namespace {
+
+uint32_t float_to_bits(float value) {
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+float bits_to_float(uint32_t bits) {
+  float value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+// fp32 -> fp16 without branches on the exponent: the float hardware performs
+// the rounding by adding a bias that lines the fp16 mantissa up with the low
+// bits of the fp32 mantissa. Handles subnormals, overflow to inf and NaN.
+uint16_t float_to_fp16(float value) {
+  const float scale_to_inf = 0x1.0p+112f;
+  const float scale_to_zero = 0x1.0p-110f;
+  float base = (std::fabs(value) * scale_to_inf) * scale_to_zero;
+
+  const uint32_t w = float_to_bits(value);
+  const uint32_t shl1_w = w + w;
+  const uint32_t sign = w & 0x80000000u;
+  uint32_t bias = shl1_w & 0xFF000000u;
+  if (bias < 0x71000000u) {
+    bias = 0x71000000u; // Smallest normal fp16 exponent
+  }
+
+  base = bits_to_float((bias >> 1) + 0x07800000u) + base;
+  const uint32_t bits = float_to_bits(base);
+  const uint32_t exp_bits = (bits >> 13) & 0x00007C00u;
+  const uint32_t mantissa_bits = bits & 0x00000FFFu;
+  const uint32_t nonsign = exp_bits + mantissa_bits;
+  const bool is_nan = shl1_w > 0xFF000000u;
+  return static_cast<uint16_t>((sign >> 16) | (is_nan ? 0x7E00u : nonsign));
+}
+
+// fp16 -> fp32: normal values are rebiased by a multiply, subnormals are
+// produced by subtracting a magic constant
+float fp16_to_float(uint16_t value) {
+  const uint32_t w = static_cast<uint32_t>(value) << 16;
+  const uint32_t sign = w & 0x80000000u;
+  const uint32_t two_w = w + w;
+
+  const uint32_t exp_offset = 0xE0u << 23;
+  const float exp_scale = 0x1.0p-112f;
+  const float normalized =
+      bits_to_float((two_w >> 4) + exp_offset) * exp_scale;
+
+  const uint32_t magic_mask = 126u << 23;
+  const float magic_bias = 0.5f;
+  const float denormalized =
+      bits_to_float((two_w >> 17) | magic_mask) - magic_bias;
+
+  const uint32_t denormalized_cutoff = 1u << 27;
+  const uint32_t result =
+      sign | (two_w < denormalized_cutoff ? float_to_bits(denormalized)
+                                          : float_to_bits(normalized));
+  return bits_to_float(result);
+}
+
+// fp32 -> bf16: keep the upper 16 bits, rounding to nearest even
+uint16_t float_to_bf16(float value) {
+  const uint32_t bits = float_to_bits(value);
+  if ((bits & 0x7FFFFFFFu) > 0x7F800000u) {
+    return static_cast<uint16_t>((bits >> 16) | 0x0040u); // Quiet NaN
+  }
+  const uint32_t rounding_bias = 0x00007FFFu + ((bits >> 16) & 1u);
+  return static_cast<uint16_t>((bits + rounding_bias) >> 16);
+}
+
+float bf16_to_float(uint16_t value) {
+  return bits_to_float(static_cast<uint32_t>(value) << 16);
+}
+
+// Upper bound on the number of weights accepted from a file, so a corrupt
+// header is reported as a parse error rather than exhausting memory
+constexpr size_t kMaxLoadedWeights = size_t(1) << 28;
+
+} // namespace
+
+ReducedMLP::ReducedMLP(const MLP &model, WeightFormat format)
+    : input_size_(model.input_size()),
+      hidden_layer_size_(model.hidden_layer_size()), format_(format) {
+  weights_.reserve(weight_count(input_size_, hidden_layer_size_));
+  for (const auto &neuron : model.hidden_weights()) {
+    for (float w : neuron) {
+      weights_.push_back(narrow(w, format_));
+    }
+  }
+  for (float w : model.output_weights()) {
+    weights_.push_back(narrow(w, format_));
+  }
+}
+
+ReducedMLP::ReducedMLP(unsigned int input_size, unsigned int hidden_layer_size,
+                       WeightFormat format, std::vector<uint16_t> weights)
+    : input_size_(input_size), hidden_layer_size_(hidden_layer_size),
+      format_(format), weights_(std::move(weights)) {
+  const size_t expected_size = weight_count(input_size_, hidden_layer_size_);
+  if (weights_.size() != expected_size) {
+    throw std::invalid_argument("weights size mismatch: expected " +
+                                std::to_string(expected_size) + " but got " +
+                                std::to_string(weights_.size()));
+  }
+}
+
+size_t ReducedMLP::weight_count(unsigned int input_size,
+                                unsigned int hidden_layer_size) {
+  const size_t row_size = static_cast<size_t>(input_size) + 1;
+  return static_cast<size_t>(hidden_layer_size) * row_size +
+         hidden_layer_size + 1;
+}
+
+uint16_t ReducedMLP::narrow(float value, WeightFormat format) {
+  return format == WeightFormat::FP16 ? float_to_fp16(value)
+                                      : float_to_bf16(value);
+}
+
+float ReducedMLP::widen(uint16_t value, WeightFormat format) {
+  return format == WeightFormat::FP16 ? fp16_to_float(value)
+                                      : bf16_to_float(value);
+}
+
+std::string ReducedMLP::format_name(WeightFormat format) {
+  return format == WeightFormat::FP16 ? "fp16" : "bf16";
+}
+
+float ReducedMLP::forward(const std::vector<float> &inputs) const {
+  // Validate input size
+  if (inputs.size() != input_size_) {
+    throw std::invalid_argument("Input size mismatch: expected " +
+                                std::to_string(input_size_) + " but got " +
+                                std::to_string(inputs.size()));
+  }
+
+  if (format_ == WeightFormat::FP16) {
+    return detail::flat_forward<uint16_t, fp16_to_float>(
+        weights_.data(), inputs, input_size_, hidden_layer_size_);
+  }
+  return detail::flat_forward<uint16_t, bf16_to_float>(
+      weights_.data(), inputs, input_size_, hidden_layer_size_);
+}
+
+MLP ReducedMLP::to_mlp() const {
+  const size_t row_size = static_cast<size_t>(input_size_) + 1;
+
+  std::vector<std::vector<float>> hidden_weights(hidden_layer_size_,
+                                                 std::vector<float>(row_size));
+  for (size_t i = 0; i < hidden_layer_size_; ++i) {
+    for (size_t j = 0; j < row_size; ++j) {
+      hidden_weights[i][j] = widen(weights_[i * row_size + j], format_);
+    }
+  }
+
+  std::vector<float> output_weights(hidden_layer_size_ + 1);
+  const size_t output_offset = hidden_layer_size_ * row_size;
+  for (size_t i = 0; i <= hidden_layer_size_; ++i) {
+    output_weights[i] = widen(weights_[output_offset + i], format_);
+  }
+
+  return MLP(input_size_, hidden_layer_size_, hidden_weights, output_weights);
+}
+
+void ReducedMLP::save_weights() const {
+  // Generate filename
+  std::string filename = "mlp_" + std::to_string(input_size_) + "_" +
+                         std::to_string(hidden_layer_size_) + "_" +
+                         format_name(format_) + ".txt";
+
+  // Open file for writing
+  std::ofstream file(filename);
+  if (!file.is_open()) {
+    throw std::runtime_error("Failed to open file for writing: " + filename);
+  }
+
+  // Header so the file can be loaded without parsing the filename
+  file << format_name(format_) << " " << input_size_ << " "
+       << hidden_layer_size_ << "\n";
+
+  // One line per hidden neuron (weights then bias), then one line for the
+  // output layer (weights then bias)
+  file << std::hex << std::setfill('0');
+  const size_t row_size = static_cast<size_t>(input_size_) + 1;
+  for (size_t i = 0; i < weights_.size(); ++i) {
+    file << std::setw(4) << weights_[i];
+    const bool end_of_hidden_row =
+        i < hidden_layer_size_ * row_size && (i + 1) % row_size == 0;
+    if (end_of_hidden_row || i == weights_.size() - 1) {
+      file << "\n";
+    } else {
+      file << " ";
+    }
+  }
+
+  file.close();
+}
+
+ReducedMLP ReducedMLP::load_weights(const std::string &filename) {
+  std::ifstream file(filename);
+  if (!file.is_open()) {
+    throw std::runtime_error("Failed to open file for reading: " + filename);
+  }
+
+  // Parse header
+  std::string format_str;
+  unsigned int input_size = 0;
+  unsigned int hidden_layer_size = 0;
+  if (!(file >> format_str >> input_size >> hidden_layer_size)) {
+    throw std::runtime_error("Invalid weights file header: " + filename);
+  }
+  WeightFormat format;
+  if (format_str == format_name(WeightFormat::FP16)) {
+    format = WeightFormat::FP16;
+  } else if (format_str == format_name(WeightFormat::BF16)) {
+    format = WeightFormat::BF16;
+  } else {
+    throw std::runtime_error("Unknown weight format: " + format_str);
+  }
+
+  // Validate dimensions before sizing anything from them
+  if (input_size == std::numeric_limits<unsigned int>::max()) {
+    throw std::runtime_error("Invalid input size in weights file header: " +
+                             filename);
+  }
+  const size_t expected_size = weight_count(input_size, hidden_layer_size);
+  if (expected_size > kMaxLoadedWeights) {
+    throw std::runtime_error("Too many weights declared in header (" +
+                             std::to_string(expected_size) + "): " + filename);
+  }
+
+  // Parse hex-encoded weights
+  std::vector<uint16_t> weights;
+  weights.reserve(expected_size);
+  unsigned int value;
+  while (file >> std::hex >> value) {
+    if (value > 0xFFFFu) {
+      throw std::runtime_error("Weight out of 16-bit range in " + filename);
+    }
+    if (weights.size() == expected_size) {
+      throw std::runtime_error("Too many weight values in " + filename);
+    }
+    weights.push_back(static_cast<uint16_t>(value));
+  }
+  if (!file.eof()) {
+    throw std::runtime_error("Invalid weight value in " + filename);
+  }
+
+  if (weights.size() != expected_size) {
+    throw std::runtime_error("Weight count mismatch in " + filename +
+                             ": expected " + std::to_string(expected_size) +
+                             " but got " + std::to_string(weights.size()));
+  }
+
+  return ReducedMLP(input_size, hidden_layer_size, format, std::move(weights));
+}
+
+std::ostream &operator<<(std::ostream &os, const ReducedMLP &mlp) {
+  const size_t row_size = static_cast<size_t>(mlp.input_size_) + 1;
+
+  os << "ReducedMLP(\n";
+  os << "  format: " << ReducedMLP::format_name(mlp.format_) << "\n";
+  os << "  input_size: " << mlp.input_size_ << "\n";
+  os << "  hidden_layer_size: " << mlp.hidden_layer_size_ << "\n";
+
+  // Print hidden weights (Input→Hidden)
+  os << "  hidden_weights (Input→Hidden): [\n";
+  for (size_t i = 0; i < mlp.hidden_layer_size_; ++i) {
+    os << "    neuron " << i << ": [";
+    for (size_t j = 0; j < row_size; ++j) {
+      os << ReducedMLP::widen(mlp.weights_[i * row_size + j], mlp.format_);
+      if (j < row_size - 1) {
+        os << ", ";
+      }
+    }
+    os << "]";
+    if (i < mlp.hidden_layer_size_ - 1) {
+      os << ",";
+    }
+    os << "\n";
+  }
+  os << "  ]\n";
+
+  // Print output weights (Hidden→Output)
+  const size_t output_offset = mlp.hidden_layer_size_ * row_size;
+  os << "  output_weights (Hidden→Output): [";
+  for (size_t i = 0; i <= mlp.hidden_layer_size_; ++i) {
+    os << ReducedMLP::widen(mlp.weights_[output_offset + i], mlp.format_);
+    if (i < mlp.hidden_layer_size_) {
+      os << ", ";
+    }
+  }
+  os << "]\n";
+  os << ")";
+
+  return os;
+}
+
+} // namespace mlp